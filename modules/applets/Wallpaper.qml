@@ -139,11 +139,9 @@ Loader {
 					anchors.fill: parent	
 					visible: false			
 
-					Image{
+					WallpaperCachedImage {
 						id: wallpaperPreviewImage
 						anchors.fill: parent
-						source: ""
-						fillMode: Image.PreserveAspectCrop
 					}
 
 					Rectangle{
@@ -221,18 +219,27 @@ Loader {
 								width: sourceRect.width * 0.04
 							}
 
-							onCurrentIndexChanged: {
-								wallpaperPreviewImage.source = folderModel.get(listView.currentIndex, "filePath")
+							function showPreview() {
+								let url = folderModel.get(listView.currentIndex, "filePath")
+								if (url === undefined) return
+								wallpaperPreviewImage.fileModified = folderModel.get(listView.currentIndex, "fileModified")
+								wallpaperPreviewImage.fileSize = folderModel.get(listView.currentIndex, "fileSize")
+								wallpaperPreviewImage.filePath = url
+								WallpaperSettings.pendingWallpaper = url
 							}
 
-							
+							onCurrentIndexChanged: showPreview()
 
-							Component.onCompleted: {
-								let url = folderModel.get(listView.currentIndex, "filePath")
-								if (url === undefined) return
-								wallpaperPreviewImage.source = url
+							Keys.onReturnPressed: {
+								if (WallpaperSettings.pendingWallpaper != "") {
+									WallpaperSettings.currentWallpaper = WallpaperSettings.pendingWallpaper
+								}
 							}
 
+							
+
+							Component.onCompleted: showPreview()
+
 
 						}
 					}
@@ -13,6 +13,7 @@ Item {
     Connections {
 		target: Signals
 		function onWallpaperPickerToggled() {
+            sWallCtrl.resetSdfCache()
 
             bwallAnimation.finished.disconnect(sWallCtrl.onFinished_nlv)
             bwallAnimation.finished.disconnect(sWallCtrl.onFinished_nr)
@@ -185,12 +186,71 @@ Item {
         function onFinished_nlv(){
             sWallCtrl.anim_running = false
             swapStartEnd()
+            reportSdfCache()
         }
 
         function onFinished_nr (){
             sWallCtrl.isOpen = false
             sWallCtrl.anim_running = false
             swapStartEnd()
+            reportSdfCache()
+        }
+
+        property bool sdf_in_budget: mwallSdf.bytes + bwallSdf.bytes <= BgSettings.sdfCacheBudget
+        property bool sdf_cached: sdf_in_budget && mwallSdf.ready && bwallSdf.ready
+
+        // One sample per frame rendered during a transition, it is a hit when the
+        // frame was drawn from baked sdfs whose keys did not change since the last one.
+        property int sdf_hits: 0
+        property int sdf_misses: 0
+        property string sdf_last_key: ""
+
+        function sampleSdfCache() {
+            let key = mwallSdf.key + "|" + bwallSdf.key
+            sdf_cached && key == sdf_last_key ? sdf_hits++ : sdf_misses++
+            sdf_last_key = key
+        }
+
+        function resetSdfCache() {
+            sWallCtrl.sdf_hits = 0
+            sWallCtrl.sdf_misses = 0
+        }
+
+        function reportSdfCache() {
+            let total = sWallCtrl.sdf_hits + sWallCtrl.sdf_misses
+            if (!BgSettings.sdfCacheLog || total == 0) return
+            console.log(`sdf cache ${root.screen.name}: ${sWallCtrl.sdf_hits}/${total} frames hit (${(100 * sWallCtrl.sdf_hits / total).toFixed(1)}%), ${sWallCtrl.sdf_cached ? ((mwallSdf.bytes + bwallSdf.bytes) / 1048576).toFixed(1) : 0} MiB`)
+        }
+    }
+
+    BgSdfCache {
+        id: mwallSdf
+        resolution: compositor.resolution
+        rectWidth: sWallCtrl.endX - sWallCtrl.startX
+        // Without the offset, so the key stays bit-identical while animating
+        rectHeight: root.height * 0.8 - root.height * 0.2
+        radius: sWallCtrl.mwall_radius
+        roundingStrength: sWallCtrl.mwall_rstrength
+        pad: compositor.sdf_pad
+        active: sWallCtrl.sdf_in_budget
+    }
+
+    BgSdfCache {
+        id: bwallSdf
+        resolution: compositor.resolution
+        rectWidth: sWallCtrl.endX - sWallCtrl.startX
+        rectHeight: BgSettings.bottomWidth + 25
+        radius: sWallCtrl.bwall_radius
+        roundingStrength: sWallCtrl.bwall_rstrength
+        pad: compositor.sdf_pad
+        active: sWallCtrl.sdf_in_budget
+    }
+
+    Connections {
+        target: root.Window.window
+        enabled: BgSettings.sdfCacheLog && sWallCtrl.anim_running
+        function onFrameSwapped() {
+            sWallCtrl.sampleSdfCache()
         }
     }
 
@@ -232,6 +292,14 @@ Item {
         property real bwall_rstrength: sWallCtrl.bwall_rstrength
         property int bwall_inverted: sWallCtrl.bwall_inverted
 
+        //Cached wallpaper rectangle sdfs, padded by the blending distance in pixels
+        property int sdf_cached: sWallCtrl.sdf_cached
+        property real sdf_pad: Math.ceil(blending * root.screen.height / 2) + 2
+        property var mwall_sdf_size: mwallSdf.textureSize
+        property var bwall_sdf_size: bwallSdf.textureSize
+        property var mwall_sdf: mwallSdf.source
+        property var bwall_sdf: bwallSdf.source
+
         fragmentShader: "Compositor.frag.qsb"
 
         
@@ -0,0 +1,59 @@
+import QtQuick
+
+// Bakes the sdf of one bezier rectangle into a float texture.
+// Only the rectangle's size and rounding are part of the key, so the
+// compositor can reuse it for every offset of an animation.
+// Nothing is allocated while active is false.
+Item {
+	id: root
+
+	required property var resolution
+	required property real rectWidth
+	required property real rectHeight
+	required property real radius
+	required property real roundingStrength
+	required property real pad
+	property bool active: true
+
+	readonly property var textureSize: Qt.size(Math.ceil(rectWidth + 2 * pad), Math.ceil(rectHeight + 2 * pad))
+	// The texture is allocated in device pixels, on scaled outputs that is
+	// devicePixelRatio squared times the logical size
+	readonly property var deviceSize: Qt.size(Math.ceil(textureSize.width * Screen.devicePixelRatio), Math.ceil(textureSize.height * Screen.devicePixelRatio))
+	// RGBA16F texel
+	readonly property real bytes: deviceSize.width * deviceSize.height * 8
+	readonly property string key: `${rectWidth}x${rectHeight}:${radius}:${roundingStrength}:${pad}`
+	readonly property bool ready: baker.status == Loader.Ready
+	readonly property var source: baker.item ? baker.item.source : null
+
+	Loader {
+		id: baker
+		active: root.active
+
+		sourceComponent: Item {
+			readonly property alias source: sdfSource
+
+			ShaderEffect {
+				id: sdf
+				width: root.textureSize.width
+				height: root.textureSize.height
+
+				property var resolution: root.resolution
+				property var target_size: Qt.size(width, height)
+				property var rect_size: Qt.size(root.rectWidth, root.rectHeight)
+				property real pad: root.pad
+				property real radius: root.radius
+				property real rstrength: root.roundingStrength
+
+				fragmentShader: "RectSdf.frag.qsb"
+			}
+
+			ShaderEffectSource {
+				id: sdfSource
+				sourceItem: sdf
+				hideSource: true
+				format: ShaderEffectSource.RGBA16F
+				textureSize: root.deviceSize
+			}
+		}
+	}
+}
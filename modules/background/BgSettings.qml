@@ -10,4 +10,10 @@ Singleton {
 	property real rightWidth: 50
 	property real radius: 36
 	property real roundingStrength: 1 - 0.9
+
+	// Upper bound in bytes for the baked wallpaper picker sdfs of one screen,
+	// over it the sdfs are not baked and the compositor solves them per pixel
+	property real sdfCacheBudget: 64 * 1024 * 1024
+	// Log the sdf cache hit rate of every picker transition
+	property bool sdfCacheLog: (Quickshell.env("FR4CTAL_SDF_CACHE_LOG") ?? "") != ""
 }
@@ -59,7 +59,9 @@ LazyLoader {
 				screen: panel.screen
 			}
 
-			Fps{}
+			Fps{
+				screen: panel.screen
+			}
 
 			Connections{
 				target: Signals
@@ -1,56 +1,267 @@
 import QtQuick
+import Quickshell
+import Quickshell.Io
+import "../../globals"
 
+// Frame pacing of this screen's window, based on frameSwapped rather than
+// animation ticks. frameSwapped is emitted on the render thread and arrives here
+// queued, so the times are when the GUI thread saw the swap notifications, in
+// whole milliseconds, not when the frames were presented.
+//
+// Capture: with FR4CTAL_FRAME_CAPTURE set, every wallpaper picker transition is
+// captured and exported to exportPath as csv.
+//
+// Replay: FR4CTAL_FRAME_REPLAY=<n> toggles the live picker n times on the first
+// screen, exports all captures as one run and, if FR4CTAL_FRAME_BASELINE points
+// to an earlier export, logs the difference to it. The shell only quits
+// afterwards with FR4CTAL_FRAME_REPLAY_QUIT set, for instances started just for
+// the replay.
+//
+// Analysis: FR4CTAL_FRAME_COMPARE=<export> logs the difference of an export to
+// FR4CTAL_FRAME_BASELINE at startup, without driving the picker or quitting.
 Item{
 	id: root
 	width: 800
 	height: 600
 	visible: true
-	
-	property int frameCount: 0
+
+	property ShellScreen screen
+
+	property real refreshRate: Screen.refreshRate > 0 ? Screen.refreshRate : 60
+	readonly property real targetInterval: 1000 / refreshRate
+	// Gaps longer than this are idle time, nothing was requested to be drawn
+	property real idleGap: 250
+	property int captureDuration: 1000
+	property bool captureEnabled: (Quickshell.env("FR4CTAL_FRAME_CAPTURE") ?? "") != "" || replay.runs > 0
+	property string exportPath: `${Quickshell.cacheDir}/frametimes-${root.screen ? root.screen.name : "screen"}.csv`
+
 	property real currentFps: 0.0
+	property var stats: emptyCapture()
+
+	// Ring buffer of swap notifications, time seen and the animation tick before it
+	property int capacity: 2048
+	property var swapTimes: new Array(capacity).fill(0)
+	property var animateTimes: new Array(capacity).fill(0)
+	property int head: 0
+	property int count: 0
+	property real lastAnimate: 0
+	property real captureStart: -1
+
+	Connections {
+		target: root.Window.window
+		function onAfterAnimating() {
+			root.lastAnimate = Date.now()
+		}
+		function onFrameSwapped() {
+			root.swapTimes[root.head] = Date.now()
+			root.animateTimes[root.head] = root.lastAnimate
+			root.head = (root.head + 1) % root.capacity
+			root.count = Math.min(root.count + 1, root.capacity)
+		}
+	}
 
 	Timer {
-        interval: 1000 // Update every 1 second
-        running: true
-        repeat: true
-        onTriggered: {
-            root.currentFps = root.frameCount;
-            root.frameCount = 0; // Reset frame count for the next interval
-        }
-    }
-
-    // Invisible Rectangle to detect frame updates
-    Rectangle {
-        id: frameDetector
-        anchors.fill: parent
-        visible: false // Make it invisible
-
-		property real test: 0
-
-        // This signal is emitted every time a frame is rendered
-        // We can use it to count frames.
-        onTestChanged: { // Or any other property that changes with every frame
-            root.frameCount++;
-        }	
-
-		NumberAnimation {
-			target: frameDetector
-			property: "test"
-			from: 0
-			to: 1
-			duration: 1000
-			running: true
-			loops: Animation.Infinite
-		}		
-    }
-
-    // Text element to display the FPS
-    Text {
-        anchors.top: parent.top
-        anchors.left: parent.left
-        anchors.margins: 10
-        text: "FPS: " + root.currentFps.toFixed(1)
-        font.pixelSize: 24
-        color: "white"
-    }
-}
\ No newline at end of file
+		interval: 1000 // Update every 1 second
+		running: true
+		repeat: true
+		onTriggered: {
+			let since = Date.now() - interval
+			root.stats = root.analyze(since)
+			root.currentFps = root.frameCount(since)
+		}
+	}
+
+	Connections {
+		target: Signals
+		enabled: root.captureEnabled
+		function onWallpaperPickerToggled() {
+			root.captureStart = Date.now()
+			captureTimer.restart()
+		}
+	}
+
+	Timer {
+		id: captureTimer
+		interval: root.captureDuration
+		onTriggered: {
+			let capture = root.analyze(root.captureStart)
+			console.log(`swap notifications ${root.screen ? root.screen.name : ""}: ${root.summary(capture)}`)
+
+			if (replayTimer.running) {
+				replay.captures.push(capture)
+				return
+			}
+			exportFile.setText(root.toCsv([capture]))
+		}
+	}
+
+	function frameCount(since) {
+		let frames = 0
+		for (let i = 1; i <= root.count; i++) {
+			if (root.swapTimes[(root.head - i + root.capacity) % root.capacity] < since) break
+			frames++
+		}
+		return frames
+	}
+
+	// Swap intervals and animate to swap latency of the notifications seen after since
+	function analyze(since) {
+		let capture = root.emptyCapture()
+		let prev = -1
+
+		for (let i = root.count; i > 0; i--) {
+			let index = (root.head - i + root.capacity) % root.capacity
+			let swap = root.swapTimes[index]
+			if (swap < since) continue
+
+			let interval = prev >= 0 ? swap - prev : 0
+			let latency = swap - root.animateTimes[index]
+			prev = swap
+
+			root.addFrame(capture, swap, interval, latency)
+		}
+
+		capture.intervals.sort((a, b) => a - b)
+		capture.latencies.sort((a, b) => a - b)
+		return capture
+	}
+
+	// Capture read back from an export. The statistics are recomputed from the
+	// rows, so late frames are counted against this screen's refresh rate.
+	function fromCsv(text) {
+		let capture = root.emptyCapture()
+		for (let line of text.split("\n")) {
+			let [swap, interval, latency] = line.split(",").map(Number)
+			if (line.startsWith("#") || isNaN(swap) || isNaN(interval) || isNaN(latency)) continue
+			root.addFrame(capture, swap, interval, latency)
+		}
+
+		capture.intervals.sort((a, b) => a - b)
+		capture.latencies.sort((a, b) => a - b)
+		return capture
+	}
+
+	function emptyCapture() {
+		return { rows: [], intervals: [], latencies: [], dropped: 0 }
+	}
+
+	function addFrame(capture, swap, interval, latency) {
+		if (interval > 0 && interval < root.idleGap) {
+			capture.intervals.push(interval)
+			capture.dropped += Math.max(0, Math.round(interval / root.targetInterval) - 1)
+		}
+		if (latency >= 0 && latency < root.idleGap) capture.latencies.push(latency)
+		capture.rows.push(`${swap},${interval},${latency}`)
+	}
+
+	function percentile(sorted, p) {
+		if (sorted.length == 0) return 0
+		return sorted[Math.min(sorted.length - 1, Math.floor(p * sorted.length))]
+	}
+
+	function summarize(captures) {
+		let intervals = [].concat(...captures.map(c => c.intervals)).sort((a, b) => a - b)
+		let latencies = [].concat(...captures.map(c => c.latencies)).sort((a, b) => a - b)
+		return {
+			frames: intervals.length,
+			p50: root.percentile(intervals, 0.5),
+			p95: root.percentile(intervals, 0.95),
+			p99: root.percentile(intervals, 0.99),
+			dropped: captures.reduce((sum, c) => sum + c.dropped, 0),
+			animate_to_swap_p95: root.percentile(latencies, 0.95)
+		}
+	}
+
+	function summary(capture) {
+		let s = root.summarize([capture])
+		return Object.keys(s).map(k => `${k}=${s[k]}`).join(" ")
+	}
+
+	// Logs the summaries of two sets of captures side by side
+	function compare(name, before, after) {
+		let a = root.summarize(before)
+		let b = root.summarize(after)
+		console.log(`swap notifications ${name}: ${Object.keys(b).map(k => `${k} ${a[k]} -> ${b[k]}`).join(", ")}`)
+	}
+
+	function toCsv(captures) {
+		let s = root.summarize(captures)
+		let lines = [`# ${Object.keys(s).map(k => `${k}=${s[k]}`).join(" ")}`, "swap_seen_ms,interval_ms,animate_to_swap_ms"]
+		for (let c of captures) lines.push(...c.rows)
+		return lines.join("\n") + "\n"
+	}
+
+	FileView {
+		id: exportFile
+		path: root.exportPath
+		blockWrites: true
+	}
+
+	FileView {
+		id: baseline
+		path: Quickshell.env("FR4CTAL_FRAME_BASELINE") ?? ""
+		blockLoading: true
+	}
+
+	FileView {
+		id: compared
+		path: Quickshell.env("FR4CTAL_FRAME_COMPARE") ?? ""
+		blockLoading: true
+	}
+
+	Component.onCompleted: {
+		if (compared.path == "" || root.screen != Quickshell.screens[0]) return
+		if (baseline.path == "") {
+			console.warn("swap notifications: FR4CTAL_FRAME_COMPARE needs FR4CTAL_FRAME_BASELINE")
+			return
+		}
+		root.compare(`${compared.path} vs ${baseline.path}`, [root.fromCsv(baseline.text())], [root.fromCsv(compared.text())])
+	}
+
+	Scope {
+		id: replay
+		property int runs: parseInt(Quickshell.env("FR4CTAL_FRAME_REPLAY") ?? "0") || 0
+		property int remaining: runs > 0 && root.screen == Quickshell.screens[0] ? runs : -1
+		property bool quit: (Quickshell.env("FR4CTAL_FRAME_REPLAY_QUIT") ?? "") != ""
+		property var captures: []
+
+		Timer {
+			id: replayTimer
+			interval: root.captureDuration + 200
+			running: replay.remaining >= 0
+			repeat: true
+			onTriggered: {
+				if (replay.remaining > 0) {
+					replay.remaining--
+					Signals.wallpaperPickerToggled()
+					return
+				}
+				replay.finish()
+			}
+		}
+
+		function finish() {
+			replayTimer.stop()
+			exportFile.setText(root.toCsv(replay.captures))
+
+			let current = root.summarize(replay.captures)
+			console.log(`swap notifications replay (${replay.runs} runs): ${Object.keys(current).map(k => `${k}=${current[k]}`).join(" ")}`)
+			if (baseline.path != "") root.compare(`replay vs ${baseline.path}`, [root.fromCsv(baseline.text())], replay.captures)
+
+			if (replay.quit) Qt.quit()
+		}
+	}
+
+	// Text element to display the FPS, from GUI-observed swap notifications
+	Text {
+		anchors.top: parent.top
+		anchors.left: parent.left
+		anchors.margins: 10
+		text: {
+			let s = root.summarize([root.stats])
+			return `FPS: ${root.currentFps.toFixed(1)}  swap interval p50 ${s.p50}  p95 ${s.p95}  p99 ${s.p99}  late ${s.dropped}`
+		}
+		font.pixelSize: 24
+		color: "white"
+	}
+}
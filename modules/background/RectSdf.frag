@@ -0,0 +1,41 @@
+#version 440
+#extension GL_GOOGLE_include_directive : enable
+
+layout(location = 0) in vec2 qt_TexCoord0;
+layout(location = 0) out vec4 fragColor;
+
+
+// Bakes the signed distance field of a single bezier rectangle into a float
+// texture. The rectangle sits at (pad, pad) inside a target of at least
+// rect_size + 2 * pad pixels, so the compositor can sample it at any
+// translation of the rectangle.
+
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    float qt_Opacity;
+	vec2 resolution;
+
+    //cached rectangle settings
+    vec2 target_size;
+    vec2 rect_size;
+    float pad;
+    float radius;
+    float rstrength;
+
+} ubuf;
+
+#include "BezierRect.glsl"
+
+
+void main() {
+    vec2 pixel = qt_TexCoord0.xy * ubuf.target_size;
+    vec2 uv = (2.0 * pixel - ubuf.resolution.xy) / ubuf.resolution.y;
+
+    vec2 start = vec2(ubuf.pad);
+    vec2 end = start + ubuf.rect_size;
+
+    float d = bezierRectancle(uv, start, end, ubuf.radius, ubuf.rstrength, 0);
+
+    // Raw distance in the red channel, the target is a float texture.
+    fragColor = vec4(d, 0.0, 0.0, 1.0);
+}
@@ -5,11 +5,24 @@
 #include <math.h>    // For M_PI, cabs, cos, sin
 #include <time.h>    // For seeding the random number generator
 #include <stdbool.h> // For the bool type
+#include <float.h>   // For DBL_EPSILON
+#include <stdint.h>  // For the fixed-size batch header fields
+#include <string.h>  // For memcmp, memcpy
+#include <fcntl.h>   // For open
+#include <unistd.h>  // For close, sysconf
+#include <sys/mman.h> // For mmap, madvise
+#include <sys/stat.h> // For fstat
 #include <omp.h>     // Include the OpenMP library header
 
 // Define a shorter name for a complex double
 typedef double complex cplx;
 
+#define CLUSTER_ISOLATION 3.0 // Other roots must be this many cluster radii away.
+#define ROUNDING_ULPS 4.0     // Residuals within this many ulps of |p| count as zero.
+#define BATCH_CHUNK 4096      // Records solved and written per batch step.
+#define BATCH_MAX_ITERATIONS 200
+#define BATCH_MAX_DEGREE 1024
+
 /**
  * @brief Evaluates a polynomial at a complex point x using Horner's method.
  */
@@ -21,10 +34,17 @@ cplx evaluate_poly(const cplx coeffs[], int degree, cplx x) {
     return result;
 }
 
+/**
+ * @brief Uniform random number in [0, 1], from seed or from rand() if seed is NULL.
+ */
+double random_unit(unsigned int* seed) {
+    return (double)(seed != NULL ? rand_r(seed) : rand()) / RAND_MAX;
+}
+
 /**
  * @brief Generates initial guesses for the roots based on the paper's method.
  */
-void generate_initial_guesses(const cplx coeffs[], int degree, cplx roots[]) {
+void generate_initial_guesses(const cplx coeffs[], int degree, cplx roots[], unsigned int* seed) {
     // Calculate the upper (U) and lower (V) bounds for the root magnitudes
     double c_n_abs = cabs(coeffs[0]);
     double c_0_abs = cabs(coeffs[degree]);
@@ -37,47 +57,326 @@ void generate_initial_guesses(const cplx coeffs[], int degree, cplx roots[]) {
     }
 
     double U = 1.0 + max_abs_coeffs / c_n_abs;
-    double V = c_0_abs / (c_0_abs + max_abs_coeffs);
+    // x^n has no lower coefficients, all its roots are 0
+    double V = (c_0_abs + max_abs_coeffs > 0) ? c_0_abs / (c_0_abs + max_abs_coeffs) : 0;
 
     for (int i = 0; i < degree; i++) {
-        double r = V + (double)rand() / RAND_MAX * (U - V);
-        double theta = (double)rand() / RAND_MAX * 2.0 * M_PI;
+        double r = V + random_unit(seed) * (U - V);
+        double theta = random_unit(seed) * 2.0 * M_PI;
         roots[i] = r * (cos(theta) + I * sin(theta));
     }
 }
 
+/**
+ * @brief Bound on the rounding error of evaluate_poly at x.
+ */
+double rounding_bound(const cplx coeffs[], int degree, cplx x) {
+    double result = 0;
+    double abs_x = cabs(x);
+    for (int i = 0; i <= degree; i++) {
+        result = result * abs_x + cabs(coeffs[i]);
+    }
+    return ROUNDING_ULPS * DBL_EPSILON * result;
+}
+
+/**
+ * @brief Checks whether the residual of p at x is finite and at rounding level.
+ *
+ * Far outside the roots both p and its bound overflow, that is not a root.
+ */
+bool at_rounding_level(const cplx coeffs[], int degree, cplx x) {
+    double residual = cabs(evaluate_poly(coeffs, degree, x));
+    return isfinite(residual) && residual <= rounding_bound(coeffs, degree, x);
+}
+
+/**
+ * @brief Groups approximations that converge to the same multiple root.
+ *
+ * The disk of radius degree * |p/p'| around an approximation contains a root.
+ * Approximations inside that disk which are also well separated from all the
+ * others form a cluster. cluster[i] is the index of the first root of i's cluster.
+ */
+void find_clusters(const cplx roots[], const cplx alphas[], int degree, int cluster[]) {
+    for (int i = 0; i < degree; i++) {
+        cluster[i] = -1;
+    }
+
+    for (int i = 0; i < degree; i++) {
+        if (cluster[i] != -1) continue;
+        cluster[i] = i;
+
+        double radius = degree * cabs(alphas[i]);
+        int members = 1;
+        for (int j = i + 1; j < degree; j++) {
+            if (cluster[j] == -1 && cabs(roots[i] - roots[j]) <= radius) {
+                cluster[j] = i;
+                members++;
+            }
+        }
+        if (members == 1) continue;
+
+        bool isolated = true;
+        for (int k = 0; k < degree; k++) {
+            if (cluster[k] != i && cabs(roots[i] - roots[k]) <= CLUSTER_ISOLATION * radius) {
+                isolated = false;
+                break;
+            }
+        }
+        if (isolated) continue;
+
+        for (int j = i + 1; j < degree; j++) {
+            if (cluster[j] == i) cluster[j] = -1;
+        }
+    }
+}
+
+/**
+ * @brief Aberth correction for a cluster of m approximations around center.
+ *
+ * With f = p'/p and beta, gamma summed over the roots outside the cluster,
+ * f - beta = m / (z - root) near a root of multiplicity m. That gives the step
+ * m / (f - beta) and the estimate m = -(f - beta)^2 / (f' + gamma). Returns false
+ * when the estimate disagrees with m, i.e. the cluster holds more approximations
+ * than the root's multiplicity or the roots are close but not multiple, and when
+ * the step does not reduce |p|.
+ */
+bool cluster_correction(const cplx coeffs[], const cplx deriv_coeffs[], const cplx deriv2_coeffs[], int degree,
+                        const cplx roots[], const int cluster[], int id, int m, cplx center, cplx* correction,
+                        double* estimate) {
+    *estimate = 0;
+
+    cplx p_val = evaluate_poly(coeffs, degree, center);
+    if (p_val == 0) return false;
+
+    cplx p_prime_val = evaluate_poly(deriv_coeffs, degree - 1, center);
+    cplx p_second_val = (degree > 1) ? evaluate_poly(deriv2_coeffs, degree - 2, center) : 0;
+
+    cplx beta = 0;
+    cplx gamma = 0;
+    for (int k = 0; k < degree; k++) {
+        if (cluster[k] == id) continue;
+        cplx inv = 1.0 / (center - roots[k]);
+        beta += inv;
+        gamma += inv * inv;
+    }
+
+    cplx f = p_prime_val / p_val;
+    cplx f_cluster = f - beta;
+    cplx f_cluster_prime = p_second_val / p_val - f * f + gamma;
+    if (f_cluster == 0 || f_cluster_prime == 0) return false;
+    *estimate = cabs(-f_cluster * f_cluster / f_cluster_prime);
+    if (fabs(*estimate - m) > 0.5) return false;
+
+    *correction = m / f_cluster;
+    return cabs(evaluate_poly(coeffs, degree, center - *correction)) < cabs(p_val);
+}
+
+/**
+ * @brief Drops all but the keep members of cluster id that are nearest to center.
+ *
+ * Dropped members get the id degree + index, so they are treated as simple roots.
+ */
+void trim_cluster(const cplx roots[], int cluster[], int degree, int id, cplx center, int keep) {
+    for (int kept = 0; kept < keep; kept++) {
+        int nearest = -1;
+        for (int j = id; j < degree; j++) {
+            if (cluster[j] != id) continue;
+            if (nearest == -1 || cabs(roots[j] - center) < cabs(roots[nearest] - center)) {
+                nearest = j;
+            }
+        }
+        cluster[nearest] = -1 - id;
+    }
+    for (int j = id; j < degree; j++) {
+        if (cluster[j] == id) cluster[j] = degree + j;
+        else if (cluster[j] == -1 - id) cluster[j] = id;
+    }
+}
+
+/**
+ * @brief Checks whether two converged approximations belong to the same root.
+ *
+ * Approximations of a multiple root end up spread over the region where p is at
+ * rounding level, so p stays at rounding level on the segment between them.
+ */
+bool same_root(const cplx coeffs[], int degree, cplx a, cplx b) {
+    if (!at_rounding_level(coeffs, degree, b)) return false;
+    // Golden ratio steps never land on an evenly spaced root between a and b.
+    for (int k = 0; k <= 4; k++) {
+        double t = k * 0.6180339887498949;
+        cplx x = a + (b - a) * (t - floor(t));
+        if (!at_rounding_level(coeffs, degree, x)) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Counts how many converged approximations share each root.
+ */
+void count_multiplicities(const cplx coeffs[], int degree, const cplx roots[], int multiplicities[]) {
+    for (int i = 0; i < degree; i++) {
+        multiplicities[i] = 0;
+    }
+
+    for (int i = 0; i < degree; i++) {
+        if (multiplicities[i] != 0) continue;
+        int m = 1;
+        for (int j = i + 1; j < degree; j++) {
+            if (multiplicities[j] == 0 && same_root(coeffs, degree, roots[i], roots[j])) {
+                multiplicities[j] = -1;
+                m++;
+            }
+        }
+        multiplicities[i] = m;
+        for (int j = i + 1; j < degree; j++) {
+            if (multiplicities[j] == -1) multiplicities[j] = m;
+        }
+    }
+}
+
 /**
  * @brief Finds all roots of a polynomial using the Aberth-Ehrlich method.
+ *
+ * Clusters of approximations to a multiple root are moved together with a
+ * multiplicity-corrected step, which keeps convergence fast on repeated roots.
+ * If multiplicities is not NULL it receives the multiplicity found for each root.
+ * The initial guesses are drawn from seed, or from rand() if seed is NULL. If
+ * converged is not NULL it is set when all corrections fell below tolerance and
+ * all residuals are finite. Roots at 0 come last.
  */
-int aberth_ehrlich_solve(const cplx coeffs[], int degree, cplx roots[], int max_iterations, double tolerance) {
+int aberth_ehrlich_solve(const cplx coeffs[], int degree, cplx roots[], int multiplicities[], int max_iterations, double tolerance,
+                         unsigned int* seed, bool* converged) {
+    // A root at 0 scales p and its rounding bound alike, so the residual tests
+    // cannot tell its approximations apart from simple roots. Zero trailing
+    // coefficients give it exactly, only the rest of the polynomial is solved.
+    int zeros = 0;
+    while (zeros < degree && coeffs[degree - zeros] == 0) zeros++;
+    if (zeros > 0) {
+        for (int i = degree - zeros; i < degree; i++) {
+            roots[i] = 0;
+            if (multiplicities != NULL) multiplicities[i] = zeros;
+        }
+        if (zeros < degree) return aberth_ehrlich_solve(coeffs, degree - zeros, roots, multiplicities, max_iterations, tolerance, seed, converged);
+        if (converged != NULL) *converged = true;
+        return 0;
+    }
+
     // Calculate Derivative Coefficients
     cplx* deriv_coeffs = (cplx*)malloc(degree * sizeof(cplx));
     for (int i = 0; i < degree; i++) {
         deriv_coeffs[i] = coeffs[i] * (degree - i);
     }
+    cplx* deriv2_coeffs = (cplx*)malloc(degree * sizeof(cplx));
+    for (int i = 0; i < degree - 1; i++) {
+        deriv2_coeffs[i] = deriv_coeffs[i] * (degree - 1 - i);
+    }
 
     // Generate Initial Guesses
-    generate_initial_guesses(coeffs, degree, roots);
+    generate_initial_guesses(coeffs, degree, roots, seed);
 
     // Main Iteration Loop
     cplx* corrections = (cplx*)malloc(degree * sizeof(cplx));
+    cplx* alphas = (cplx*)malloc(degree * sizeof(cplx));
+    bool* at_root = (bool*)malloc(degree * sizeof(bool));
+    int* cluster = (int*)malloc(degree * sizeof(int));
+    int* mults = (int*)malloc(degree * sizeof(int));
     int iterations = 0;
+    bool finished = false;
     for (iterations = 0; iterations < max_iterations; iterations++) {
         bool all_converged = true;
 
+        // Newton steps first, the cluster detection compares them to the root separation.
+        #pragma omp parallel for
+        for (int i = 0; i < degree; i++) {
+            cplx p_val = evaluate_poly(coeffs, degree, roots[i]);
+            cplx p_prime_val = evaluate_poly(deriv_coeffs, degree - 1, roots[i]);
+            alphas[i] = (p_prime_val != 0) ? p_val / p_prime_val : 0;
+            // A residual at rounding level is a root, p/p' there is only noise.
+            at_root[i] = isfinite(cabs(p_val)) && cabs(p_val) <= rounding_bound(coeffs, degree, roots[i]);
+            mults[i] = 1;
+        }
+
+        find_clusters(roots, alphas, degree, cluster);
+
+        // Each cluster moves as one multiple root.
+        for (int i = 0; i < degree; i++) {
+            if (cluster[i] != i) continue;
+
+            // Shrink the cluster to the estimated multiplicity until its step is consistent.
+            int m;
+            cplx center;
+            cplx correction;
+            bool accepted = false;
+            for (;;) {
+                m = 0;
+                center = 0;
+                bool members_at_root = true;
+                for (int j = i; j < degree; j++) {
+                    if (cluster[j] != i) continue;
+                    center += roots[j];
+                    members_at_root = members_at_root && at_root[j];
+                    m++;
+                }
+                if (m < 2) break;
+                center /= m;
+
+                // Members spread over the rounding noise of one multiple root, their mean is the
+                // best estimate. p' vanishes there as well, unlike at a simple root.
+                members_at_root = members_at_root &&
+                    at_rounding_level(coeffs, degree, center) &&
+                    cabs(evaluate_poly(deriv_coeffs, degree - 1, center)) <= degree * rounding_bound(deriv_coeffs, degree - 1, center);
+
+                correction = 0;
+                double estimate = m;
+                if (members_at_root ||
+                    cluster_correction(coeffs, deriv_coeffs, deriv2_coeffs, degree, roots, cluster, i, m, center, &correction, &estimate)) {
+                    accepted = true;
+                    break;
+                }
+
+                int keep = (int)lround(estimate);
+                if (keep < 2 || keep >= m) break;
+                trim_cluster(roots, cluster, degree, i, center, keep);
+            }
+            if (!accepted) continue;
+
+            // Members are spread over a circle of the step's size around the new
+            // center, so a pair of close simple roots can still be told apart.
+            int k = 0;
+            for (int j = i; j < degree; j++) {
+                if (cluster[j] != i) continue;
+                cplx spread = cabs(correction) * cexp(I * (0.5 + 2.0 * M_PI * k++ / m));
+                mults[j] = m;
+                corrections[j] = roots[j] - (center - correction + spread);
+            }
+            if (cabs(correction) > tolerance) {
+                all_converged = false;
+            }
+        }
+
         // This pragma tells OpenMP to parallelize the following for-loop.
         // The work of calculating corrections for each root is split among threads.
         // The reduction clause safely handles the update of 'all_converged'.
         #pragma omp parallel for reduction(&&:all_converged)
         for (int i = 0; i < degree; i++) {
-            cplx p_val = evaluate_poly(coeffs, degree, roots[i]);
-            cplx p_prime_val = evaluate_poly(deriv_coeffs, degree - 1, roots[i]);
-            cplx alpha = (p_prime_val != 0) ? p_val / p_prime_val : 0;
+            if (mults[i] > 1) continue;
+            cplx alpha = at_root[i] ? 0 : alphas[i];
             cplx beta = 0;
+            bool duplicate = false;
             for (int j = 0; j < degree; j++) {
                 if (i == j) continue;
+                if (roots[i] == roots[j]) {
+                    duplicate = duplicate || j < i;
+                    continue;
+                }
                 beta += 1.0 / (roots[i] - roots[j]);
             }
+            // A rejected cluster leaves its members on one point, push them apart again.
+            if (duplicate) {
+                corrections[i] = 1e-3 * (1.0 + cabs(roots[i])) * cexp(I * i);
+                all_converged = false;
+                continue;
+            }
             cplx denominator = 1.0 - alpha * beta;
             corrections[i] = (denominator != 0) ? alpha / denominator : alpha;
             if (cabs(corrections[i]) > tolerance) {
@@ -93,20 +392,207 @@ int aberth_ehrlich_solve(const cplx coeffs[], int degree, cplx roots[], int max_
 
         if (all_converged) {
             iterations++;
+            finished = true;
             break;
         }
     }
 
+    if (converged != NULL) {
+        *converged = finished;
+        for (int i = 0; i < degree; i++) {
+            *converged = *converged && isfinite(cabs(evaluate_poly(coeffs, degree, roots[i])));
+        }
+    }
+
+    if (multiplicities != NULL) {
+        count_multiplicities(coeffs, degree, roots, multiplicities);
+    }
+
     // Clean up allocated memory
     free(deriv_coeffs);
+    free(deriv2_coeffs);
     free(corrections);
+    free(alphas);
+    free(at_root);
+    free(cluster);
+    free(mults);
 
     return iterations;
 }
 
-int main() {
+/**
+ * @brief Header of the binary batch files, followed by count fixed-stride records.
+ *
+ * Input records hold the degree + 1 coefficients, highest power first, as
+ * complex doubles. Output records hold the degree roots, their residuals |p(root)|
+ * as doubles, and the iteration count and a converged flag as int32. All values
+ * use the host byte order. Records with a zero leading coefficient or non-finite
+ * coefficients are not solved, they get NaN roots, 0 iterations and converged 0.
+ */
+typedef struct {
+    char magic[4];
+    uint32_t degree;
+    uint64_t count;
+} batch_header;
+
+static const char BATCH_INPUT_MAGIC[4] = {'A', 'E', 'B', 'I'};
+static const char BATCH_OUTPUT_MAGIC[4] = {'A', 'E', 'B', 'O'};
+
+size_t batch_input_stride(uint32_t degree) {
+    return ((size_t)degree + 1) * sizeof(cplx);
+}
+
+size_t batch_output_stride(uint32_t degree) {
+    return (size_t)degree * (sizeof(cplx) + sizeof(double)) + 2 * sizeof(int32_t);
+}
+
+/**
+ * @brief Solves every record of a batch file and streams the results to output_path.
+ *
+ * The input is mapped and read in chunks of BATCH_CHUNK records, the records of a
+ * chunk are solved in parallel. Pages of finished chunks are released, so memory
+ * stays bounded by the chunk size however large the input is. Each record draws
+ * its initial guesses from a seed derived from its index, so results do not
+ * depend on the thread schedule.
+ */
+int solve_batch(const char* input_path, const char* output_path) {
+    int fd = open(input_path, O_RDONLY);
+    if (fd < 0) {
+        printf("Error: Cannot open %s.\n", input_path);
+        return 1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(batch_header)) {
+        printf("Error: %s is not a batch file.\n", input_path);
+        close(fd);
+        return 1;
+    }
+
+    unsigned char* input = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (input == MAP_FAILED) {
+        printf("Error: Cannot map %s.\n", input_path);
+        return 1;
+    }
+    madvise(input, st.st_size, MADV_SEQUENTIAL);
+
+    batch_header header;
+    memcpy(&header, input, sizeof(header));
+    size_t in_stride = batch_input_stride(header.degree);
+    size_t out_stride = batch_output_stride(header.degree);
+    if (memcmp(header.magic, BATCH_INPUT_MAGIC, 4) != 0 || header.degree < 1 || header.degree > BATCH_MAX_DEGREE ||
+        header.count > (st.st_size - sizeof(header)) / in_stride ||
+        sizeof(header) + header.count * in_stride != (size_t)st.st_size) {
+        printf("Error: %s is not a batch file.\n", input_path);
+        munmap(input, st.st_size);
+        return 1;
+    }
+
+    // Truncating the mapped input would fault on the next read
+    struct stat out_st;
+    if (stat(output_path, &out_st) == 0 && out_st.st_dev == st.st_dev && out_st.st_ino == st.st_ino) {
+        printf("Error: Output %s is the input file.\n", output_path);
+        munmap(input, st.st_size);
+        return 1;
+    }
+
+    FILE* output = fopen(output_path, "wb");
+    unsigned char* results = malloc(BATCH_CHUNK * out_stride);
+    if (output == NULL || results == NULL) {
+        printf("Error: Cannot write %s.\n", output_path);
+        if (output != NULL) fclose(output);
+        free(results);
+        munmap(input, st.st_size);
+        return 1;
+    }
+
+    batch_header out_header = header;
+    memcpy(out_header.magic, BATCH_OUTPUT_MAGIC, 4);
+    bool ok = fwrite(&out_header, sizeof(out_header), 1, output) == 1;
+
+    // Records are the parallel unit here, the solver's own loops stay serial.
+    omp_set_max_active_levels(1);
+
+    int degree = header.degree;
+    size_t page = sysconf(_SC_PAGESIZE);
+    size_t released = 0;
+    uint64_t converged = 0;
+    double start = omp_get_wtime();
+    for (uint64_t first = 0; first < header.count && ok; first += BATCH_CHUNK) {
+        int n = (header.count - first < BATCH_CHUNK) ? (int)(header.count - first) : BATCH_CHUNK;
+        const unsigned char* records = input + sizeof(header) + first * in_stride;
+
+        #pragma omp parallel for schedule(dynamic, 16) reduction(+:converged)
+        for (int r = 0; r < n; r++) {
+            cplx coeffs[degree + 1];
+            cplx roots[degree];
+            double residuals[degree];
+            memcpy(coeffs, records + r * in_stride, in_stride);
+
+            bool valid = coeffs[0] != 0;
+            for (int i = 0; i <= degree; i++) {
+                valid = valid && isfinite(creal(coeffs[i])) && isfinite(cimag(coeffs[i]));
+            }
+
+            int32_t result[2] = {0, 0};
+            if (valid) {
+                unsigned int seed = (unsigned int)(first + r) * 2654435761u + 1;
+                bool solved = false;
+                result[0] = aberth_ehrlich_solve(coeffs, degree, roots, NULL, BATCH_MAX_ITERATIONS, 1e-15, &seed, &solved);
+                for (int i = 0; i < degree; i++) {
+                    residuals[i] = cabs(evaluate_poly(coeffs, degree, roots[i]));
+                    solved = solved && isfinite(residuals[i]);
+                }
+                result[1] = solved;
+            } else {
+                for (int i = 0; i < degree; i++) {
+                    roots[i] = CMPLX(NAN, NAN);
+                    residuals[i] = NAN;
+                }
+            }
+            converged += result[1];
+
+            unsigned char* out = results + r * out_stride;
+            memcpy(out, roots, sizeof(roots));
+            memcpy(out + sizeof(roots), residuals, sizeof(residuals));
+            memcpy(out + sizeof(roots) + sizeof(residuals), result, sizeof(result));
+        }
+
+        ok = fwrite(results, out_stride, n, output) == (size_t)n;
+
+        size_t done = (sizeof(header) + (first + n) * in_stride) / page * page;
+        if (done > released) {
+            madvise(input + released, done - released, MADV_DONTNEED);
+            released = done;
+        }
+    }
+    double end = omp_get_wtime();
+
+    ok = fclose(output) == 0 && ok;
+    free(results);
+    munmap(input, st.st_size);
+    if (!ok) {
+        printf("Error: Cannot write %s.\n", output_path);
+        return 1;
+    }
+
+    printf("Solved %llu polynomials of degree %d, %llu converged.\n",
+           (unsigned long long)header.count, degree, (unsigned long long)converged);
+    printf("Execution time: %f seconds.\n", end - start);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
     srand(time(NULL));
 
+    if (argc > 1) {
+        if (argc == 4 && strcmp(argv[1], "--batch") == 0) {
+            return solve_batch(argv[2], argv[3]);
+        }
+        printf("Usage: %s [--batch <input> <output>]\n", argv[0]);
+        return 1;
+    }
+
     // You can set the number of threads OpenMP should use
     // omp_set_num_threads(4); // Example: use 4 threads
 
@@ -117,7 +603,7 @@ int main() {
 
     printf("--- Solving Polynomial 1: x^4 - 5x^2 + 4 ---\n");
     double start1 = omp_get_wtime(); // Use OpenMP's timer
-    int iters1 = aberth_ehrlich_solve(coeffs1, degree1, roots1, 100, 1e-15);
+    int iters1 = aberth_ehrlich_solve(coeffs1, degree1, roots1, NULL, 100, 1e-15, NULL, NULL);
     double end1 = omp_get_wtime();
     
     printf("Converged in %d iterations.\n", iters1);
@@ -138,7 +624,7 @@ int main() {
 
     printf("--- Solving Polynomial 2: Random 12th degree ---\n");
     double start2 = omp_get_wtime();
-    int iters2 = aberth_ehrlich_solve(coeffs2, degree2, roots2, 200, 1e-15);
+    int iters2 = aberth_ehrlich_solve(coeffs2, degree2, roots2, NULL, 200, 1e-15, NULL, NULL);
     double end2 = omp_get_wtime();
     
     printf("Converged in %d iterations.\n", iters2);
@@ -146,5 +632,43 @@ int main() {
     // printf("Found roots:\n"); // Omitted for brevity
     printf("----------------------------------------\n\n");
 
+    // --- Polynomial 3: Repeated roots, (x-1)^3 (x-2)^2 (x+3) ---
+    int degree3 = 6;
+    cplx coeffs3[] = {1, -4, -2, 32, -59, 44, -12};
+    cplx roots3[degree3];
+    int mults3[degree3];
+
+    printf("--- Solving Polynomial 3: (x-1)^3 (x-2)^2 (x+3) ---\n");
+    double start3 = omp_get_wtime();
+    int iters3 = aberth_ehrlich_solve(coeffs3, degree3, roots3, mults3, 200, 1e-15, NULL, NULL);
+    double end3 = omp_get_wtime();
+
+    printf("Converged in %d iterations.\n", iters3);
+    printf("Execution time: %f seconds.\n", end3 - start3);
+    printf("Found roots:\n");
+    for (int i = 0; i < degree3; i++) {
+        printf("  %.6f + %.6fi  (multiplicity %d)\n", creal(roots3[i]), cimag(roots3[i]), mults3[i]);
+    }
+    printf("----------------------------------------\n\n");
+
+    // --- Polynomial 4: Multiple root at 0, x^3 (x-1)^2 (x+2) ---
+    int degree4 = 6;
+    cplx coeffs4[] = {1, 0, -3, 2, 0, 0, 0};
+    cplx roots4[degree4];
+    int mults4[degree4];
+
+    printf("--- Solving Polynomial 4: x^3 (x-1)^2 (x+2) ---\n");
+    double start4 = omp_get_wtime();
+    int iters4 = aberth_ehrlich_solve(coeffs4, degree4, roots4, mults4, 200, 1e-15, NULL, NULL);
+    double end4 = omp_get_wtime();
+
+    printf("Converged in %d iterations.\n", iters4);
+    printf("Execution time: %f seconds.\n", end4 - start4);
+    printf("Found roots:\n");
+    for (int i = 0; i < degree4; i++) {
+        printf("  %.6f + %.6fi  (multiplicity %d)\n", creal(roots4[i]), cimag(roots4[i]), mults4[i]);
+    }
+    printf("----------------------------------------\n\n");
+
     return 0;
 }
\ No newline at end of file
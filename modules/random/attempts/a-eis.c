@@ -4,10 +4,14 @@
 #include <math.h>    // For M_PI, cabs, cos, sin
 #include <time.h>    // For seeding the random number generator
 #include <stdbool.h> // For the bool type
+#include <float.h>   // For DBL_EPSILON
 
 // Define a shorter name for a complex double
 typedef double complex cplx;
 
+#define CLUSTER_ISOLATION 3.0 // Other roots must be this many cluster radii away.
+#define ROUNDING_ULPS 4.0     // Residuals within this many ulps of |p| count as zero.
+
 /**
  * @brief Prints a polynomial in a human-readable format.
  */
@@ -75,44 +79,336 @@ void generate_initial_guesses(const cplx coeffs[], int degree, cplx roots[]) {
     }
 }
 
+/**
+ * @brief Bound on the rounding error of evaluate_poly at x.
+ */
+double rounding_bound(const cplx coeffs[], int degree, cplx x) {
+    double result = 0;
+    double abs_x = cabs(x);
+    for (int i = 0; i <= degree; i++) {
+        result = result * abs_x + cabs(coeffs[i]);
+    }
+    return ROUNDING_ULPS * DBL_EPSILON * result;
+}
+
+/**
+ * @brief Checks whether the residual of p at x is finite and at rounding level.
+ *
+ * Far outside the roots both p and its bound overflow, that is not a root.
+ */
+bool at_rounding_level(const cplx coeffs[], int degree, cplx x) {
+    double residual = cabs(evaluate_poly(coeffs, degree, x));
+    return isfinite(residual) && residual <= rounding_bound(coeffs, degree, x);
+}
+
+/**
+ * @brief Groups approximations that converge to the same multiple root.
+ *
+ * The disk of radius degree * |p/p'| around an approximation contains a root.
+ * Approximations inside that disk which are also well separated from all the
+ * others form a cluster. cluster[i] is the index of the first root of i's cluster.
+ */
+void find_clusters(const cplx roots[], const cplx alphas[], int degree, int cluster[]) {
+    for (int i = 0; i < degree; i++) {
+        cluster[i] = -1;
+    }
+
+    for (int i = 0; i < degree; i++) {
+        if (cluster[i] != -1) continue;
+        cluster[i] = i;
+
+        double radius = degree * cabs(alphas[i]);
+        int members = 1;
+        for (int j = i + 1; j < degree; j++) {
+            if (cluster[j] == -1 && cabs(roots[i] - roots[j]) <= radius) {
+                cluster[j] = i;
+                members++;
+            }
+        }
+        if (members == 1) continue;
+
+        bool isolated = true;
+        for (int k = 0; k < degree; k++) {
+            if (cluster[k] != i && cabs(roots[i] - roots[k]) <= CLUSTER_ISOLATION * radius) {
+                isolated = false;
+                break;
+            }
+        }
+        if (isolated) continue;
+
+        for (int j = i + 1; j < degree; j++) {
+            if (cluster[j] == i) cluster[j] = -1;
+        }
+    }
+}
+
+/**
+ * @brief Aberth correction for a cluster of m approximations around center.
+ *
+ * With f = p'/p and beta, gamma summed over the roots outside the cluster,
+ * f - beta = m / (z - root) near a root of multiplicity m. That gives the step
+ * m / (f - beta) and the estimate m = -(f - beta)^2 / (f' + gamma). Returns false
+ * when the estimate disagrees with m, i.e. the cluster holds more approximations
+ * than the root's multiplicity or the roots are close but not multiple, and when
+ * the step does not reduce |p|.
+ */
+bool cluster_correction(const cplx coeffs[], const cplx deriv_coeffs[], const cplx deriv2_coeffs[], int degree,
+                        const cplx roots[], const int cluster[], int id, int m, cplx center, cplx* correction,
+                        double* estimate) {
+    *estimate = 0;
+
+    cplx p_val = evaluate_poly(coeffs, degree, center);
+    if (p_val == 0) return false;
+
+    cplx p_prime_val = evaluate_poly(deriv_coeffs, degree - 1, center);
+    cplx p_second_val = (degree > 1) ? evaluate_poly(deriv2_coeffs, degree - 2, center) : 0;
+
+    cplx beta = 0;
+    cplx gamma = 0;
+    for (int k = 0; k < degree; k++) {
+        if (cluster[k] == id) continue;
+        cplx inv = 1.0 / (center - roots[k]);
+        beta += inv;
+        gamma += inv * inv;
+    }
+
+    cplx f = p_prime_val / p_val;
+    cplx f_cluster = f - beta;
+    cplx f_cluster_prime = p_second_val / p_val - f * f + gamma;
+    if (f_cluster == 0 || f_cluster_prime == 0) return false;
+    *estimate = cabs(-f_cluster * f_cluster / f_cluster_prime);
+    if (fabs(*estimate - m) > 0.5) return false;
+
+    *correction = m / f_cluster;
+    return cabs(evaluate_poly(coeffs, degree, center - *correction)) < cabs(p_val);
+}
+
+/**
+ * @brief Drops all but the keep members of cluster id that are nearest to center.
+ *
+ * Dropped members get the id degree + index, so they are treated as simple roots.
+ */
+void trim_cluster(const cplx roots[], int cluster[], int degree, int id, cplx center, int keep) {
+    for (int kept = 0; kept < keep; kept++) {
+        int nearest = -1;
+        for (int j = id; j < degree; j++) {
+            if (cluster[j] != id) continue;
+            if (nearest == -1 || cabs(roots[j] - center) < cabs(roots[nearest] - center)) {
+                nearest = j;
+            }
+        }
+        cluster[nearest] = -1 - id;
+    }
+    for (int j = id; j < degree; j++) {
+        if (cluster[j] == id) cluster[j] = degree + j;
+        else if (cluster[j] == -1 - id) cluster[j] = id;
+    }
+}
+
+/**
+ * @brief Checks whether two converged approximations belong to the same root.
+ *
+ * Approximations of a multiple root end up spread over the region where p is at
+ * rounding level, so p stays at rounding level on the segment between them.
+ */
+bool same_root(const cplx coeffs[], int degree, cplx a, cplx b) {
+    if (!at_rounding_level(coeffs, degree, b)) return false;
+    // Golden ratio steps never land on an evenly spaced root between a and b.
+    for (int k = 0; k <= 4; k++) {
+        double t = k * 0.6180339887498949;
+        cplx x = a + (b - a) * (t - floor(t));
+        if (!at_rounding_level(coeffs, degree, x)) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Counts how many converged approximations share each root.
+ */
+void count_multiplicities(const cplx coeffs[], int degree, const cplx roots[], int multiplicities[]) {
+    for (int i = 0; i < degree; i++) {
+        multiplicities[i] = 0;
+    }
+
+    for (int i = 0; i < degree; i++) {
+        if (multiplicities[i] != 0) continue;
+        int m = 1;
+        for (int j = i + 1; j < degree; j++) {
+            if (multiplicities[j] == 0 && same_root(coeffs, degree, roots[i], roots[j])) {
+                multiplicities[j] = -1;
+                m++;
+            }
+        }
+        multiplicities[i] = m;
+        for (int j = i + 1; j < degree; j++) {
+            if (multiplicities[j] == -1) multiplicities[j] = m;
+        }
+    }
+}
+
 /**
  * @brief Finds all roots of a polynomial using the Aberth-Ehrlich method.
+ *
+ * Clusters of approximations to a multiple root are moved together with a
+ * multiplicity-corrected step, which keeps convergence fast on repeated roots.
+ * If multiplicities is not NULL it receives the multiplicity found for each root.
+ * Roots at 0 come last.
  */
-int aberth_ehrlich_solve(const cplx coeffs[], int degree, cplx roots[], int max_iterations, double tolerance) {
+int aberth_ehrlich_solve(const cplx coeffs[], int degree, cplx roots[], int multiplicities[], int max_iterations, double tolerance) {
+    // A root at 0 scales p and its rounding bound alike, so the residual tests
+    // cannot tell its approximations apart from simple roots. Zero trailing
+    // coefficients give it exactly, only the rest of the polynomial is solved.
+    int zeros = 0;
+    while (zeros < degree && coeffs[degree - zeros] == 0) zeros++;
+    if (zeros > 0) {
+        for (int i = degree - zeros; i < degree; i++) {
+            roots[i] = 0;
+            if (multiplicities != NULL) multiplicities[i] = zeros;
+        }
+        if (zeros < degree) return aberth_ehrlich_solve(coeffs, degree - zeros, roots, multiplicities, max_iterations, tolerance);
+        return 0;
+    }
+
+    // Calculate Derivative Coefficients
     cplx* deriv_coeffs = (cplx*)malloc(degree * sizeof(cplx));
     for (int i = 0; i < degree; i++) {
         deriv_coeffs[i] = coeffs[i] * (degree - i);
     }
+    cplx* deriv2_coeffs = (cplx*)malloc(degree * sizeof(cplx));
+    for (int i = 0; i < degree - 1; i++) {
+        deriv2_coeffs[i] = deriv_coeffs[i] * (degree - 1 - i);
+    }
+
+    // Generate Initial Guesses
     generate_initial_guesses(coeffs, degree, roots);
+
+    // Main Iteration Loop
     cplx* corrections = (cplx*)malloc(degree * sizeof(cplx));
+    cplx* alphas = (cplx*)calloc(degree, sizeof(cplx));
+    bool* at_root = (bool*)malloc(degree * sizeof(bool));
+    int* cluster = (int*)malloc(degree * sizeof(int));
+    int* mults = (int*)malloc(degree * sizeof(int));
     int iterations = 0;
     for (iterations = 0; iterations < max_iterations; iterations++) {
         bool all_converged = true;
+
+        // Newton steps first, the cluster detection compares them to the root separation.
         for (int i = 0; i < degree; i++) {
             cplx p_val = evaluate_poly(coeffs, degree, roots[i]);
             cplx p_prime_val = evaluate_poly(deriv_coeffs, degree - 1, roots[i]);
-            cplx alpha = (p_prime_val != 0) ? p_val / p_prime_val : 0;
+            alphas[i] = (p_prime_val != 0) ? p_val / p_prime_val : 0;
+            // A residual at rounding level is a root, p/p' there is only noise.
+            at_root[i] = isfinite(cabs(p_val)) && cabs(p_val) <= rounding_bound(coeffs, degree, roots[i]);
+            mults[i] = 1;
+        }
+
+        find_clusters(roots, alphas, degree, cluster);
+
+        // Each cluster moves as one multiple root.
+        for (int i = 0; i < degree; i++) {
+            if (cluster[i] != i) continue;
+
+            // Shrink the cluster to the estimated multiplicity until its step is consistent.
+            int m;
+            cplx center;
+            cplx correction;
+            bool accepted = false;
+            for (;;) {
+                m = 0;
+                center = 0;
+                bool members_at_root = true;
+                for (int j = i; j < degree; j++) {
+                    if (cluster[j] != i) continue;
+                    center += roots[j];
+                    members_at_root = members_at_root && at_root[j];
+                    m++;
+                }
+                if (m < 2) break;
+                center /= m;
+
+                // Members spread over the rounding noise of one multiple root, their mean is the
+                // best estimate. p' vanishes there as well, unlike at a simple root.
+                members_at_root = members_at_root &&
+                    at_rounding_level(coeffs, degree, center) &&
+                    cabs(evaluate_poly(deriv_coeffs, degree - 1, center)) <= degree * rounding_bound(deriv_coeffs, degree - 1, center);
+
+                correction = 0;
+                double estimate = m;
+                if (members_at_root ||
+                    cluster_correction(coeffs, deriv_coeffs, deriv2_coeffs, degree, roots, cluster, i, m, center, &correction, &estimate)) {
+                    accepted = true;
+                    break;
+                }
+
+                int keep = (int)lround(estimate);
+                if (keep < 2 || keep >= m) break;
+                trim_cluster(roots, cluster, degree, i, center, keep);
+            }
+            if (!accepted) continue;
+
+            // Members are spread over a circle of the step's size around the new
+            // center, so a pair of close simple roots can still be told apart.
+            int k = 0;
+            for (int j = i; j < degree; j++) {
+                if (cluster[j] != i) continue;
+                cplx spread = cabs(correction) * cexp(I * (0.5 + 2.0 * M_PI * k++ / m));
+                mults[j] = m;
+                corrections[j] = roots[j] - (center - correction + spread);
+            }
+            if (cabs(correction) > tolerance) {
+                all_converged = false;
+            }
+        }
+
+        for (int i = 0; i < degree; i++) {
+            if (mults[i] > 1) continue;
+            cplx alpha = at_root[i] ? 0 : alphas[i];
             cplx beta = 0;
+            bool duplicate = false;
             for (int j = 0; j < degree; j++) {
                 if (i == j) continue;
+                if (roots[i] == roots[j]) {
+                    duplicate = duplicate || j < i;
+                    continue;
+                }
                 beta += 1.0 / (roots[i] - roots[j]);
             }
+            // A rejected cluster leaves its members on one point, push them apart again.
+            if (duplicate) {
+                corrections[i] = 1e-3 * (1.0 + cabs(roots[i])) * cexp(I * i);
+                all_converged = false;
+                continue;
+            }
             cplx denominator = 1.0 - alpha * beta;
             corrections[i] = (denominator != 0) ? alpha / denominator : alpha;
             if (cabs(corrections[i]) > tolerance) {
                 all_converged = false;
             }
         }
+        
         for (int i = 0; i < degree; i++) {
             roots[i] -= corrections[i];
         }
+
         if (all_converged) {
             iterations++;
             break;
         }
     }
+
+    if (multiplicities != NULL) {
+        count_multiplicities(coeffs, degree, roots, multiplicities);
+    }
+
+    // Clean up allocated memory
     free(deriv_coeffs);
+    free(deriv2_coeffs);
     free(corrections);
+    free(alphas);
+    free(at_root);
+    free(cluster);
+    free(mults);
+
     return iterations;
 }
 
@@ -192,8 +488,11 @@ int main() {
                 }
 
                 cplx* user_roots = (cplx*)malloc(last_degree * sizeof(cplx));
-                if (user_roots == NULL) {
+                int* user_mults = (int*)malloc(last_degree * sizeof(int));
+                if (user_roots == NULL || user_mults == NULL) {
                     printf("Error: Memory allocation for roots failed.\n");
+                    free(user_roots);
+                    free(user_mults);
                     break;
                 }
 
@@ -202,7 +501,7 @@ int main() {
                 print_polynomial(last_coeffs, last_degree);
 
                 clock_t start_user = clock();
-                int iters_user = aberth_ehrlich_solve(last_coeffs, last_degree, user_roots, max_iterations, 1e-15);
+                int iters_user = aberth_ehrlich_solve(last_coeffs, last_degree, user_roots, user_mults, max_iterations, 1e-15);
                 clock_t end_user = clock();
                 double time_user = ((double)(end_user - start_user)) / CLOCKS_PER_SEC;
 
@@ -210,9 +509,10 @@ int main() {
                 printf("Execution time: %f seconds.\n", time_user);
                 printf("Found roots:\n");
                 for (int i = 0; i < last_degree; i++) {
-                    printf("  %.6f + %.6fi\n", creal(user_roots[i]), cimag(user_roots[i]));
+                    printf("  %.6f + %.6fi  (multiplicity %d)\n", creal(user_roots[i]), cimag(user_roots[i]), user_mults[i]);
                 }
                 free(user_roots);
+                free(user_mults);
                 break;
             }
             case 3: // Change max iterations
@@ -1,6 +1,7 @@
 
 import QtQuick
 import QtQuick.Shapes
+import Quickshell
 import "WallpaperSettings.qml"
 
 import Qt5Compat.GraphicalEffects
@@ -10,6 +11,7 @@ Item{
     anchors.fill: parent
 
     property real val: 0
+    property ShellScreen screen
 
     PropertyAnimation {
         running: true
@@ -21,15 +23,12 @@ Item{
         easing.type: Easing.InOutCubic
     }
 
-    Image {
+    WallpaperScreenVariant {
         id: img
         x: root.width/2
         y:0
-        width: root.width
-        height: root.height
-        
-        source: "/home/solo/Pictures/wallpapers/a_foggy_mountain_with_trees_01.png"
-        fillMode: Image.PreserveAspectCrop
+        screen: root.screen
+        wallpaper: WallpaperSettings.currentWallpaper
         smooth: true
         visible: false
     }
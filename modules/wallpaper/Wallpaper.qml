@@ -32,7 +32,37 @@ LazyLoader {
 			anchors.left: true
 			anchors.right: true
 			
-			S3wClone {}
+			S3wClone {
+				screen: panel.screen
+			}
+
+			// Crops the wallpaper highlighted in the picker for this screen in
+			// the background, so applying it is a cache hit. Only once the
+			// highlight settles, scrolling through the picker decodes nothing.
+			property string prefetchWallpaper: ""
+
+			Connections {
+				target: WallpaperSettings
+				function onPendingWallpaperChanged() {
+					prefetchDelay.restart()
+				}
+			}
+
+			Timer {
+				id: prefetchDelay
+				interval: 600
+				onTriggered: panel.prefetchWallpaper = WallpaperSettings.pendingWallpaper
+			}
+
+			Loader {
+				active: panel.prefetchWallpaper != "" && panel.prefetchWallpaper != WallpaperSettings.currentWallpaper
+				asynchronous: true
+				sourceComponent: WallpaperScreenVariant {
+					screen: panel.screen
+					wallpaper: panel.prefetchWallpaper
+					visible: false
+				}
+			}
 		}	
 	}
 }
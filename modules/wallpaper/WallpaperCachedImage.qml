@@ -0,0 +1,54 @@
+import QtQuick
+
+// Wallpaper image that decodes the original only once, already downscaled to
+// the item size, and afterwards loads that copy from the thumbnail cache.
+// The cache key changes with the file's mtime and size, so edited or replaced
+// wallpapers are picked up without clearing the cache.
+Image {
+	id: root
+
+	property string filePath: ""
+	property var fileModified
+	property real fileSize: 0
+	// Any format QImage can write, bmp skips compression for large images
+	property string cacheFormat: "png"
+	// Device pixels per item pixel of the decoded and cached copy
+	property real pixelRatio: 1
+
+	readonly property size targetSize: Qt.size(Math.ceil(width * pixelRatio), Math.ceil(height * pixelRatio))
+	readonly property string cachePath: {
+		if (filePath == "" || targetSize.width <= 0 || targetSize.height <= 0) return ""
+		let mtime = fileModified ? fileModified.getTime() : 0
+		let key = Qt.md5(`${filePath}:${mtime}:${fileSize}:${targetSize.width}x${targetSize.height}`)
+		return `${WallpaperSettings.thumbnailDir}/${key}.${cacheFormat}`
+	}
+	property bool cached: true
+
+	asynchronous: true
+	fillMode: Image.PreserveAspectCrop
+	sourceSize: targetSize
+	source: {
+		if (cachePath == "") return ""
+		return cached ? `file://${cachePath}` : `file://${filePath}`
+	}
+
+	onCachePathChanged: cached = true
+
+	onStatusChanged: {
+		// Cache miss, decode the original at the target size instead
+		if (status == Image.Error && cached) {
+			cached = false
+			return
+		}
+
+		if (status == Image.Ready && cached) {
+			WallpaperSettings.touchThumbnail(cachePath)
+			return
+		}
+
+		if (status == Image.Ready && !cached) {
+			let path = cachePath
+			grabToImage(result => WallpaperSettings.saveThumbnail(result, path), targetSize)
+		}
+	}
+}
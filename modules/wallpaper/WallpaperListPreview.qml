@@ -10,6 +10,8 @@ Item{
 	id: root
 	required property string filePath
 	required property string fileName
+	required property var fileModified
+	required property real fileSize
 	property ListView listView
 	property Item source
 
@@ -22,11 +24,12 @@ Item{
 		anchors.topMargin: parent.height * 0.125
 		anchors.bottomMargin: parent.height * 0.125
 
-		Image {
+		WallpaperCachedImage {
 			id: img
 			anchors.fill: parent
-			source: root.filePath
-			fillMode: Image.PreserveAspectCrop
+			filePath: root.filePath
+			fileModified: root.fileModified
+			fileSize: root.fileSize
 			visible: false
 		}
 
@@ -0,0 +1,47 @@
+import QtQuick
+import Qt.labs.folderlistmodel
+import Quickshell
+
+// A wallpaper cropped to exactly one screen. The crop is kept uncompressed in
+// the thumbnail cache, so showing it again only reads the pixels back without
+// decoding or scaling the original.
+WallpaperCachedImage {
+	id: root
+
+	required property ShellScreen screen
+	required property string wallpaper
+
+	width: screen.width
+	height: screen.height
+	// Full resolution on scaled outputs, the screen size is in logical pixels
+	pixelRatio: screen.devicePixelRatio
+	cacheFormat: "bmp"
+
+	// Path, mtime and size of the wallpaper, only replaced once the model has
+	// scanned the new file. Until then the previous wallpaper stays, so the
+	// original is never decoded under a stale key and the image is not blanked.
+	property var file: null
+	filePath: file ? file.path : ""
+	fileModified: file ? file.modified : undefined
+	fileSize: file ? file.size : 0
+
+	function updateFile() {
+		if (stat.status != FolderListModel.Ready || stat.count == 0) return
+		let path = stat.get(0, "filePath")
+		if (path != wallpaper) return
+		file = { path: path, modified: stat.get(0, "fileModified"), size: stat.get(0, "fileSize") }
+	}
+
+	onWallpaperChanged: updateFile()
+
+	FolderListModel {
+		id: stat
+		folder: `file://${root.wallpaper.substring(0, root.wallpaper.lastIndexOf("/"))}`
+		// Wildcards in the name only match themselves inside brackets
+		nameFilters: [root.wallpaper.substring(root.wallpaper.lastIndexOf("/") + 1).replace(/[*?[]/g, "[$&]")]
+		showDirs: false
+
+		onStatusChanged: root.updateFile()
+		onCountChanged: root.updateFile()
+	}
+}
@@ -1,14 +1,86 @@
 pragma Singleton
 
+import QtQuick
 import Quickshell
+import Quickshell.Io
 import "../../globals"
 
 Singleton {
 	id: root
 
-	property string currentWallpaper : ""
+	property string currentWallpaper : "/home/solo/Pictures/wallpapers/a_foggy_mountain_with_trees_01.png"
+	// Wallpaper highlighted in the picker, prepared for every screen ahead of time
+	property string pendingWallpaper : ""
 	property string wallpaperDir : "/home/solo/Pictures/wallpapers"
 	property int animationCenter : Globals.AnimationCenter.Random
 	property string lastActiveWindow: ""
 
-}
\ No newline at end of file
+	// Downscaled copies of the wallpapers used by the picker
+	property string thumbnailDir: `${Quickshell.cacheDir}/thumbnails`
+	// Least recently used copies are removed above this size, and copies not
+	// used for thumbnailMaxAge days (old mtimes and sizes) in any case. Use is
+	// tracked in the mtime, which every cache hit refreshes, since access times
+	// are not updated on noatime mounts and only coarsely under relatime.
+	property real thumbnailCacheLimit: 512 * 1024 * 1024
+	property int thumbnailMaxAge: 30
+
+	// Saves a grabbed image to the thumbnail cache, creating the directory
+	// first if the save fails because it does not exist yet
+	function saveThumbnail(result, path) {
+		if (result.saveToFile(path)) {
+			root.pruneThumbnails()
+			return
+		}
+		root.pendingSaves.push(() => {
+			if (!result.saveToFile(path)) console.warn(`wallpaper: cannot write ${path}`)
+		})
+		mkdir.running = true
+	}
+
+	function pruneThumbnails() {
+		pruneTimer.restart()
+	}
+
+	// Marks a cached copy as used, so pruning keeps it
+	function touchThumbnail(path) {
+		root.touchedThumbnails.push(path)
+		touchTimer.restart()
+	}
+
+	property var pendingSaves: []
+	property var touchedThumbnails: []
+
+	Process {
+		id: mkdir
+		command: ["mkdir", "-p", root.thumbnailDir]
+		running: true
+		onExited: {
+			let saves = root.pendingSaves
+			root.pendingSaves = []
+			for (let save of saves) save()
+			root.pruneThumbnails()
+		}
+	}
+
+	// Batches the hits of a whole picker or screen update into one run
+	Timer {
+		id: touchTimer
+		interval: 1000
+		onTriggered: {
+			Quickshell.execDetached(["touch", "-c", "--", ...root.touchedThumbnails])
+			root.touchedThumbnails = []
+		}
+	}
+
+	// Batches the pruning of many saves in a row into one run
+	Timer {
+		id: pruneTimer
+		interval: 5000
+		onTriggered: Quickshell.execDetached(["sh", "-c", `
+			cd "$1" 2>/dev/null || exit 0
+			find . -maxdepth 1 -type f -mtime +"$3" -delete
+			find . -maxdepth 1 -type f -printf '%T@ %s %p\\n' | sort -rn |
+				awk -v limit="$2" '{ total += $2; if (total > limit) print $3 }' | xargs -r rm -f
+		`, "sh", root.thumbnailDir, `${root.thumbnailCacheLimit}`, `${root.thumbnailMaxAge}`])
+	}
+}